@@ -0,0 +1,31 @@
+#ifndef CAMERAPATH_H_
+#define CAMERAPATH_H_
+
+#include <vector>
+#include <string>
+
+/*Camera position along a path: center and width of the frame in the complex plane, rotation in degrees and iteration budget*/
+struct Keyframe{
+    float r_center;
+    float i_center;
+    float width;
+    float rotation;
+    int max_iter;
+    //Distance between sample points, 0 derives it from the width so every frame has the pixel count of a standard frame
+    float resolution;
+
+    //Default is the unzoomed view of the set
+    Keyframe() : r_center(0.0f), i_center(0.0f), width(4.0f), rotation(0.0f), max_iter(100), resolution(0.0f) {}
+    Keyframe(float r_center, float i_center, float width, float rotation, int max_iter) 
+    : r_center(r_center), i_center(i_center), width(width), rotation(rotation), max_iter(max_iter), resolution(0.0f) {}
+};
+
+/*Read keyframes from a text file, one "r_center i_center width rotation max_iter" per line, '#' starts a comment.
+Returns false if the file cannot be read, a line is malformed or there are no keyframes*/
+bool loadKeyframes(const std::string& path, std::vector<Keyframe>& keyframes);
+
+/*Spread n_frames camera positions evenly over the keyframes with monotone cubic interpolation, widths are interpolated in log space.
+Values never overshoot their neighboring keyframes, so consecutive keyframes with the same center hold the camera on it*/
+std::vector<Keyframe> interpolatePath(const std::vector<Keyframe>& keyframes, int n_frames);
+
+#endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "complex.h"
 #include "mandelbrot.h"
+#include "cameraPath.h"
 #include <omp.h>
 #include <vector>
 #include <iostream>
@@ -11,7 +12,19 @@
 #include <iomanip>
 #include <chrono>
 
-/*Generates images of Mandelbrot set in complex space at different centers/resolutions in parallel to create a movie*/
-void generateFrames(int max_procs, int n_frames, std::string region, bool save_frames, std::string output_dir, float zoom_factor, float standard_res);
+/*Look up the center of a built-in zoom region ("Seahorse", "Elephant Valley", "Feigenbaum"), returns false if undefined*/
+bool regionCenter(const std::string& region, float& r_center, float& i_center);
+
+/*Probes the cost of every frame at low resolution, returns frame indices in decreasing order of cost (LPT order)*/
+std::vector<int> scheduleFrames(int max_procs, const std::vector<Keyframe>& frames, std::vector<long>& costs);
+
+/*Renders one image per camera position in parallel, frames are dispatched in decreasing order of their probed cost.
+aa_samples > 1 enables adaptive anti-aliasing with up to aa_samples^2 samples on pixels crossing more than aa_threshold iterations*/
+void renderFrames(int max_procs, const std::vector<Keyframe>& frames, bool save_frames, std::string output_dir, float standard_res, int aa_samples, int aa_threshold);
+
+/*Generates images of Mandelbrot set in complex space at different centers/resolutions in parallel to create a movie.
+region is either a built-in region zoomed by zoom_factor per frame, or a keyframe file the frames are interpolated along*/
+void generateFrames(int max_procs, int n_frames, std::string region, bool save_frames, std::string output_dir, float zoom_factor, float standard_res, 
+    int aa_samples, int aa_threshold);
 
 #endif
\ No newline at end of file
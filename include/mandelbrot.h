@@ -3,6 +3,8 @@
 
 #include "complex.h"
 #include <vector>
+#include <utility>
+#include <random>
 #include <math.h>
 #include <omp.h>
 
@@ -28,6 +30,8 @@ protected:
     float resolution;
     //Range of the space we are sampling in
     float r_max, r_min, i_max, i_min;
+    //Rotation of the sampled space about its center in radians
+    float rotation;
 
     //Declare space in which set exists as a 2D array
     int n_rows, n_cols;
@@ -35,6 +39,20 @@ protected:
 
     //Declare space in solution exists (each entry is a pixel value) determined by number of iterations
     std::vector<std::vector<Pixel>> image;
+
+    //Iterations spent by the last anti-aliased generation relative to its single sample pass
+    double aa_cost;
+    //Pixels refined with extra samples by the last anti-aliased generation
+    std::vector<std::pair<int, int>> refined;
+
+    //Flag pixels whose 8-neighborhood differs by more than iter_threshold iterations
+    std::vector<std::pair<int, int>> flagEdges(const std::vector<std::vector<int>>& iters, int iter_threshold);
+
+    //Evolve one jittered sample inside cell (cx, cy) of the samples_per_axis x samples_per_axis grid over pixel (i, j)
+    int sampleCell(int i, int j, int cx, int cy, int samples_per_axis, std::minstd_rand& rng);
+
+    //Resample a flagged pixel and store the averaged color, returns iterations spent
+    long refinePixel(const std::vector<std::vector<int>>& iters, int i, int j, int samples_per_axis, int iter_threshold);
 public:
     //Default constructor, sets a 20x20 square grid to sample from. Max_iter=255 and a threshold=2.
     Mandelbrot(){
@@ -51,6 +69,8 @@ public:
         this->n_cols = ceil((i_max - i_min)/resolution);
         this->grid = std::vector<std::vector<Complex>>(n_rows, std::vector<Complex>(n_cols, Complex()));
         this->image = std::vector<std::vector<Pixel>>(n_rows, std::vector<Pixel>(n_cols, Pixel()));
+        this->rotation = 0.0f;
+        this->aa_cost = 1.0;
 
     }
 
@@ -68,8 +88,18 @@ public:
         this->n_cols = ceil((i_max - i_min)/resolution);
         this->grid = std::vector<std::vector<Complex>>(n_rows, std::vector<Complex>(n_cols, Complex()));
         this->image = std::vector<std::vector<Pixel>>(n_rows, std::vector<Pixel>(n_cols, Pixel()));
+        this->rotation = 0.0f;
+        this->aa_cost = 1.0;
+    }
+
+    //Rotate the sampled space about its center, takes effect on the next generation
+    void setRotation(float angle){
+        this->rotation = angle;
     }
 
+    //Rotate an unrotated sample point about the center of the space
+    Complex rotatePoint(float real, float imag) const;
+
     //Map an iteration to pixel value, higher iterations/convergence produce darker pixel; using Escape Time Convergence
     Pixel mapPixel(int iter);
 
@@ -82,9 +112,36 @@ public:
     //Generates set, serial computation
     void generateImage();
 
+    //Evolves every point of the grid without producing an image, returns total iterations (cheap cost probe at low resolution)
+    long countIterations();
+
+    //Generates set with adaptive anti-aliasing: pixels whose neighbors differ by more than iter_threshold iterations
+    //are resampled with up to samples_per_axis^2 jittered samples in a second pass, serial computation
+    void generateImageAA(int samples_per_axis, int iter_threshold);
+
+    //Cost of the last anti-aliased generation, 1.0 means no more work than a single sample per pixel
+    double getAACost() const{
+        return this->aa_cost;
+    }
+
+    //Number of pixels refined by the last anti-aliased generation
+    long getRefined() const{
+        return (long)this->refined.size();
+    }
+
+    //Row and column of every pixel refined by the last anti-aliased generation
+    const std::vector<std::pair<int, int>>& getRefinedPixels() const{
+        return this->refined;
+    }
+
     //Save image as a .ppm file
     void saveImage(const std::string& filename);
 
+    //Read-only access to the generated image
+    const std::vector<std::vector<Pixel>>& getImage() const{
+        return this->image;
+    }
+
 };
 
 
@@ -112,6 +169,60 @@ public:
     //Generates image by evolving sets in parallel
     void generateImage();
 
+    //Generates image with adaptive anti-aliasing, both passes in parallel
+    void generateImageAA(int samples_per_axis, int iter_threshold);
+
+};
+
+
+/*Boundary tracing generation: only pixels on the contours between iteration bands are evolved, enclosed areas are filled.
+The image is split into horizontal strips which are traced in parallel, strips share their seam rows.*/
+class TracingMandelbrot : public ParallelMandelbrot{
+protected:
+    //Number of strips the image is partitioned into
+    int n_strips;
+    //Number of pixels evolved while tracing during the last generation, excludes confirmed interior pixels
+    long n_evaluated;
+    //Number of filled interior pixels confirmed with cycle detection during the last generation
+    long n_confirmed;
+
+    //Evolve a single pixel if it has not been evaluated yet and queue it for tracing
+    void loadPixel(std::vector<std::vector<int>>& iters, std::vector<std::pair<int, int>>& queue, int i, int j);
+
+    //Evolves Mandelbrot set for c, exits early once the orbit becomes periodic
+    int confirmSet(Complex c);
+
+    //Trace the band contours between seam rows top and bottom (both already evaluated) and fill the enclosed areas, returns pixels evolved
+    long traceStrip(std::vector<std::vector<int>>& iters, int top, int bottom, long& confirmed);
+public:
+    //Default constructor, sets a 20x20 square grid to sample from. Max_iter=255 and a threshold=2.
+    TracingMandelbrot() : ParallelMandelbrot(){
+        this->n_strips = 4*this->max_procs;
+        this->n_evaluated = 0;
+        this->n_confirmed = 0;
+    }
+
+    TracingMandelbrot(int max_procs, int max_iter, float thresh, float res, float r_max, float r_min, float i_max, float i_min)
+    : ParallelMandelbrot(max_procs, max_iter, thresh, res, r_max, r_min, i_max, i_min){
+        //Oversubscribe strips so threads stay busy when strips differ in cost
+        this->n_strips = 4*this->max_procs;
+        this->n_evaluated = 0;
+        this->n_confirmed = 0;
+    }
+
+    //Generates image by tracing band contours in parallel strips
+    void generateImage();
+
+    //Number of pixels evolved while tracing by the last call to generateImage, confirmed interior pixels are counted by getConfirmed
+    long getEvaluated() const{
+        return this->n_evaluated;
+    }
+
+    //Number of filled interior pixels confirmed by the last call to generateImage
+    long getConfirmed() const{
+        return this->n_confirmed;
+    }
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef TESTS_H_
+#define TESTS_H_
+
+/*Compare boundary traced images against the brute force generator on every built-in region, returns number of mismatched pixels*/
+long testBoundaryTrace(int max_procs, float standard_res);
+
+/*Check adaptive anti-aliasing on every built-in region and report its extra work, returns number of failed checks*/
+int testAntialiasing(int max_procs, float standard_res);
+
+/*Check keyframe parsing, path interpolation and cost ordering of frames, returns number of failed checks*/
+int testCameraPath(int max_procs);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+/*Keyframe based camera paths for zoom animations*/
+#include "cameraPath.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <math.h>
+
+/*Read keyframes from a text file, one per line*/
+bool loadKeyframes(const std::string& path, std::vector<Keyframe>& keyframes){
+    std::ifstream file(path);
+    if(!file){
+        std::cerr << "Could not open keyframe file: " << path << "\n";
+        return false;
+    }
+
+    keyframes.clear();
+    std::string line;
+    int line_num = 0;
+    while(std::getline(file, line)){
+        line_num++;
+        //Strip comments and skip blank lines
+        line = line.substr(0, line.find('#'));
+        if(line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::istringstream fields(line);
+        Keyframe key;
+        if(!(fields >> key.r_center >> key.i_center >> key.width >> key.rotation >> key.max_iter) || key.width <= 0.0f || key.max_iter <= 0){
+            std::cerr << "Malformed keyframe on line " << line_num << " of " << path << "\n";
+            return false;
+        }
+        keyframes.push_back(key);
+    }
+
+    if(keyframes.empty()){
+        std::cerr << "No keyframes in " << path << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+/*Tangent at p1 for a monotone cubic through evenly spaced p0, p1, p2 (Fritsch-Carlson): zero at extrema and where
+neighbors coincide, otherwise the Catmull-Rom tangent limited so the curve cannot overshoot*/
+static double monotoneTangent(double p0, double p1, double p2){
+    double d0 = p1 - p0;
+    double d1 = p2 - p1;
+    if(d0*d1 <= 0.0) return 0.0;
+    double m = 0.5*(d0 + d1);
+    double limit = 3.0*std::min(fabs(d0), fabs(d1));
+
+    return fabs(m) > limit ? copysign(limit, m) : m;
+}
+
+/*Cubic Hermite segment from p1 to p2 at u in [0, 1], p0 and p3 shape the tangents*/
+static double interpolate(double p0, double p1, double p2, double p3, double u){
+    double m1 = monotoneTangent(p0, p1, p2);
+    double m2 = monotoneTangent(p1, p2, p3);
+    double u2 = u*u;
+    double u3 = u2*u;
+    return (2.0*u3 - 3.0*u2 + 1.0)*p1 + (u3 - 2.0*u2 + u)*m1 + (-2.0*u3 + 3.0*u2)*p2 + (u3 - u2)*m2;
+}
+
+/*Spread n_frames camera positions evenly over the keyframes*/
+std::vector<Keyframe> interpolatePath(const std::vector<Keyframe>& keyframes, int n_frames){
+    std::vector<Keyframe> frames;
+    if(keyframes.empty() || n_frames <= 0) return frames;
+    int n_keys = (int)keyframes.size();
+
+    for(int frame = 0; frame < n_frames; frame++){
+        if(n_keys == 1){
+            frames.push_back(keyframes[0]);
+            continue;
+        }
+
+        //Position along the path in units of keyframe segments
+        double t = n_frames == 1 ? 0.0 : (double)frame/(n_frames - 1)*(n_keys - 1);
+        int seg = std::min((int)t, n_keys - 2);
+        double u = t - seg;
+        //End keyframes are repeated so the camera eases in and out of them
+        const Keyframe& k0 = keyframes[std::max(seg - 1, 0)];
+        const Keyframe& k1 = keyframes[seg];
+        const Keyframe& k2 = keyframes[seg + 1];
+        const Keyframe& k3 = keyframes[std::min(seg + 2, n_keys - 1)];
+
+        Keyframe key;
+        key.r_center = (float)interpolate(k0.r_center, k1.r_center, k2.r_center, k3.r_center, u);
+        key.i_center = (float)interpolate(k0.i_center, k1.i_center, k2.i_center, k3.i_center, u);
+        //Zooming is geometric, so widths move smoothly in log space
+        key.width = (float)exp(interpolate(log(k0.width), log(k1.width), log(k2.width), log(k3.width), u));
+        key.rotation = (float)interpolate(k0.rotation, k1.rotation, k2.rotation, k3.rotation, u);
+        key.max_iter = std::max(1, (int)lround(interpolate(k0.max_iter, k1.max_iter, k2.max_iter, k3.max_iter, u)));
+        frames.push_back(key);
+    }
+
+    return frames;
+}
@@ -2,6 +2,7 @@
 #include "complex.h"
 #include "mandelbrot.h"
 #include "frameGenerator.h"
+#include "cameraPath.h"
 #include <omp.h>
 #include <vector>
 #include <iostream>
@@ -9,12 +10,12 @@
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <algorithm>
+#include <math.h>
 
 
-void generateFrames(int max_procs, int n_frames, std::string region, bool save_frames, std::string output_dir, float zoom_factor, float standard_res){
-    //Set the center of zoom based on region
-    float r_center = 0.0f;
-    float i_center = 0.0f;
+/*Look up the center of a built-in zoom region, returns false if the region is undefined*/
+bool regionCenter(const std::string& region, float& r_center, float& i_center){
     if(region == "Seahorse"){
         r_center = -0.743643887037151;
         i_center = 0.131825904205330;
@@ -28,35 +29,68 @@ void generateFrames(int max_procs, int n_frames, std::string region, bool save_f
         i_center = 0.0;             
     }
     else{
-        printf("Region Undefined: {%s}, aborting", region.c_str());
-        return;
+        return false;
+    }
+
+    return true;
+}
+
+/*Estimate every frame from a low resolution probe and order the frames by decreasing cost (LPT order)*/
+std::vector<int> scheduleFrames(int max_procs, const std::vector<Keyframe>& frames, std::vector<long>& costs){
+    float thresh = 2.0f;
+    int probe_size = 32;             //Probe is probe_size x probe_size samples
+    int n_frames = (int)frames.size();
+
+    //Probe cost of every frame in parallel
+    costs = std::vector<long>(n_frames, 0);
+#pragma omp parallel for num_threads(max_procs) schedule(dynamic, 1)
+    for (int frame = 0; frame < n_frames; frame++) {
+        const Keyframe& key = frames[frame];
+        float res = key.width/probe_size;
+        Mandelbrot probe(key.max_iter, thresh, res, key.r_center + key.width/2.0f, key.r_center - key.width/2.0f, 
+        key.i_center + key.width/2.0f, key.i_center - key.width/2.0f);
+        probe.setRotation(key.rotation*(float)M_PI/180.0f);
+        costs[frame] = probe.countIterations();
     }
 
+    //Dispatching the longest frames first keeps the last thread from finishing alone on the deepest frame
+    std::vector<int> order(n_frames);
+    for (int frame = 0; frame < n_frames; frame++) order[frame] = frame;
+    std::stable_sort(order.begin(), order.end(), [&costs](int a, int b){ return costs[a] > costs[b]; });
+
+    return order;
+}
+
+/*Estimate every frame from a low resolution probe, then render the most expensive frames first*/
+void renderFrames(int max_procs, const std::vector<Keyframe>& frames, bool save_frames, std::string output_dir, float standard_res, int aa_samples, int aa_threshold){
     //Frame generation constant params
-    //float standard_res = 0.005f;    //Scaled with zoom
-    float standard_width = 4.0f;     //Scaled with zoom
-    float standard_height = 4.0f;    //Scaled with zoom
-    int max_iter = 100;
+    float standard_width = 4.0f;     //Frame width that is sampled at standard_res
     float thresh = 2.0f;
-    //Set amount of zoom between frames, TODO: Make it depend on n_frames
-    //float zoom_factor = 1.01;
+    int n_frames = (int)frames.size();
+
     auto start_time = std::chrono::high_resolution_clock::now();
+    std::vector<long> costs;
+    std::vector<int> order = scheduleFrames(max_procs, frames, costs);
+
     //Generate frames in parallel
-#pragma omp parallel for num_threads(max_procs)
-    for (int frame = 0; frame < n_frames; frame++) {
-        //Scale resolution
-        float res = standard_res/std::pow(zoom_factor, frame);
-        //Calculate width, height, and image borders
-        float width = standard_width*(res/standard_res);
-        float height = standard_height*(res/standard_res);
-        float r_min = r_center - width/2.0f;
-        float r_max = r_center + width/2.0f;
-        float i_min = i_center - height/2.0f;
-        float i_max = i_center + height/2.0f;
+#pragma omp parallel for num_threads(max_procs) schedule(dynamic, 1)
+    for (int k = 0; k < n_frames; k++) {
+        int frame = order[k];
+        const Keyframe& key = frames[frame];
+        //Without an explicit resolution every frame keeps the pixel count of a standard frame
+        float res = key.resolution > 0.0f ? key.resolution : standard_res*(key.width/standard_width);
+        //Calculate image borders
+        float r_min = key.r_center - key.width/2.0f;
+        float r_max = key.r_center + key.width/2.0f;
+        float i_min = key.i_center - key.width/2.0f;
+        float i_max = key.i_center + key.width/2.0f;
 
         //Create Mandelbrot instance
-        Mandelbrot mandelbrot(max_iter, thresh, res, r_max, r_min, i_max, i_min);
-        mandelbrot.generateImage();
+        Mandelbrot mandelbrot(key.max_iter, thresh, res, r_max, r_min, i_max, i_min);
+        mandelbrot.setRotation(key.rotation*(float)M_PI/180.0f);
+        //Frames render serially on their own thread, anti-aliasing uses the serial generator as well
+        if(aa_samples > 1) mandelbrot.generateImageAA(aa_samples, aa_threshold);
+        else mandelbrot.generateImage();
 
         //Create filename and save image
         std::ostringstream filename;
@@ -67,12 +101,44 @@ void generateFrames(int max_procs, int n_frames, std::string region, bool save_f
         #pragma omp critical
         {
             int thread_idx = omp_get_thread_num();
-            printf("Thread %3d: Generated Frame %4d of %4d at resolution %.10f\n", thread_idx, frame, n_frames, res);
+            printf("Thread %3d: Generated Frame %4d of %4d at resolution %.10f (estimated cost %ld)\n", thread_idx, frame, n_frames, res, costs[frame]);
         }
     }
     auto end_time = std::chrono::high_resolution_clock::now();
     double duration = std::chrono::duration<double>(end_time - start_time).count();
     printf("Frame generation completed in %.10f seconds\n", duration);
 
+    return;
+}
+
+void generateFrames(int max_procs, int n_frames, std::string region, bool save_frames, std::string output_dir, float zoom_factor, float standard_res, 
+    int aa_samples, int aa_threshold){
+    std::vector<Keyframe> frames;
+    float standard_width = 4.0f;     //Scaled with zoom
+    int max_iter = 100;
+
+    //Built-in regions zoom geometrically into their center, anything else is read as a keyframe file
+    float r_center = 0.0f;
+    float i_center = 0.0f;
+    if(regionCenter(region, r_center, i_center)){
+        for (int frame = 0; frame < n_frames; frame++) {
+            //Scale resolution, width follows from it
+            float res = standard_res/std::pow(zoom_factor, frame);
+            float width = standard_width*(res/standard_res);
+            Keyframe key(r_center, i_center, width, 0.0f, max_iter);
+            key.resolution = res;
+            frames.push_back(key);
+        }
+    }
+    else{
+        std::vector<Keyframe> keyframes;
+        if(!loadKeyframes(region, keyframes)){
+            printf("Region Undefined: {%s}, aborting", region.c_str());
+            return;
+        }
+        frames = interpolatePath(keyframes, n_frames);
+    }
+
+    renderFrames(max_procs, frames, save_frames, output_dir, standard_res, aa_samples, aa_threshold);
     return;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "complex.h"
 #include "frameGenerator.h"
 #include "mandelbrot.h"
+#include "tests.h"
 #include <omp.h>
 #include <vector>
 #include <iostream>
@@ -13,13 +14,29 @@
 /*Arguments:
 *   argv[1] -- (int) number of processors to use in generation
 *   argv[2] -- (int) number of frames to generate
-*   argv[3] -- (char*) region to generate ("Seahorse", "Elephant Valley", "Feigenbaum")
-*   argv[4] -- (bool) save files or not
+*   argv[3] -- (char*) region to generate ("Seahorse", "Elephant Valley", "Feigenbaum") or path to a keyframe file
+*   argv[4] -- (bool) save files or not, "1" or "true"
 *   argv[5] -- (char*) dir to save frames
-*   argv[6] -- (float) zoom factor between frames, 1.025 is a 2.5% zoom between frames
+*   argv[6] -- (float) zoom factor between frames, 1.025 is a 2.5% zoom between frames (ignored for keyframe files)
 *   argv[7] -- (float) standard resolution of a frame with no zoom (will be scaled with dimensions)
+*   argv[8] -- (int, optional) anti-aliasing samples per axis, 0 or 1 disables anti-aliasing
+*   argv[9] -- (int, optional) iteration difference between neighbors that triggers anti-aliasing of a pixel, defaults to 32
+*
+*Test mode: "test [n_procs] [standard_res]" runs the comparison harnesses in tests.cpp, exits non-zero on failure
 */
 int main(int argc, char** argv){
+    if(argc >= 2 && std::string(argv[1]) == "test"){
+        int test_procs = argc >= 3 ? std::stoi(argv[2]) : omp_get_num_procs();
+        float test_res = argc >= 4 ? std::stof(argv[3]) : 0.01f;
+        long mismatches = testBoundaryTrace(test_procs, test_res);
+        printf("Boundary tracing: %ld mismatched pixels\n", mismatches);
+        int aa_failures = testAntialiasing(test_procs, test_res);
+        printf("Anti-aliasing: %d failed checks\n", aa_failures);
+        int failures = testCameraPath(test_procs);
+        printf("Camera path: %d failed checks\n", failures);
+        return mismatches == 0 && aa_failures == 0 && failures == 0 ? 0 : 1;
+    }
+
     //Parse args
     int max_procs = 1;
     int n_frames = 10;
@@ -28,19 +45,29 @@ int main(int argc, char** argv){
     std::string output_dir = "../figures/frames/";
     float zoom_factor = 1.025f;
     float standard_res = 0.001f;    //Scaled with zoom
+    int aa_samples = 0;             //Anti-aliasing disabled
+    int aa_threshold = 32;
 
-    if(argc == 8){
+    if(argc > 10){
+        printf("Too many arguments (%d), expected at most 9\n", argc - 1);
+        return 1;
+    }
+    else if(argc >= 8){
         max_procs = std::stoi(argv[1]);
         n_frames = std::stoi(argv[2]);
         region = std::string(argv[3]);
-        save_frames = std::stoi(argv[4]) == 1;
+        save_frames = std::string(argv[4]) == "1" || std::string(argv[4]) == "true";
         output_dir = std::string(argv[5]);
         zoom_factor = std::stof(argv[6]);
         standard_res = std::stof(argv[7]);
+        if(argc >= 9) aa_samples = std::stoi(argv[8]);
+        if(argc == 10) aa_threshold = std::stoi(argv[9]);
         printf("Using %d processors to generate %d frames of %s at a %.6f standard resolution and %.4f zoom factor\n", 
         max_procs, n_frames, region.c_str(), standard_res, zoom_factor);
         if(save_frames) printf("Saving generated frames to %s\n", output_dir.c_str());
         else printf("Not saving generated frames\n");
+        if(aa_samples > 1) printf("Anti-aliasing with up to %dx%d samples where neighbors differ by more than %d iterations\n", 
+        aa_samples, aa_samples, aa_threshold);
     }
     else{
         printf("Insufficient arguments, using %d processors to generate %d frames of %s at a %.6f standard resolution and %.4f zoom factor\n"
@@ -49,7 +76,7 @@ int main(int argc, char** argv){
     }
 
     //Generate frames
-    generateFrames(max_procs, n_frames, region, save_frames, output_dir, zoom_factor, standard_res);
+    generateFrames(max_procs, n_frames, region, save_frames, output_dir, zoom_factor, standard_res, aa_samples, aa_threshold);
 
     return 0;
 }
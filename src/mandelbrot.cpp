@@ -3,6 +3,9 @@
 #include <omp.h>
 #include <vector>
 #include <math.h>
+#include <algorithm>
+#include <random>
+#include <stdlib.h>
 #include <iostream>
 #include <fstream>
 
@@ -21,6 +24,19 @@ Pixel Mandelbrot::mapPixel(int iter){
     return Pixel(r, g, b);
 }
 
+/*Rotate a sample point about the center of the space, points are left untouched without rotation*/
+Complex Mandelbrot::rotatePoint(float real, float imag) const{
+    if(this->rotation == 0.0f) return Complex(real, imag);
+    float r_center = (r_max + r_min)/2.0f;
+    float i_center = (i_max + i_min)/2.0f;
+    float cos_a = cos(this->rotation);
+    float sin_a = sin(this->rotation);
+    float dr = real - r_center;
+    float di = imag - i_center;
+
+    return Complex(r_center + dr*cos_a - di*sin_a, i_center + dr*sin_a + di*cos_a);
+}
+
 /*Assign each point in grid a complex value*/
 void Mandelbrot::makeGrid(){
     for(int i = 0; i < n_rows; i++){
@@ -28,7 +44,7 @@ void Mandelbrot::makeGrid(){
             float real = (float)j*this->resolution + r_min;
             float imag = (float)i*this->resolution + i_min;
 
-            this->grid[i][j] = Complex(real, imag);
+            this->grid[i][j] = rotatePoint(real, imag);
         }
     }
 
@@ -64,6 +80,142 @@ void Mandelbrot::generateImage(){
     return;
 }
 
+/*Sum iterations over the grid, used to estimate the cost of a frame from a low resolution version of it*/
+long Mandelbrot::countIterations(){
+    makeGrid();
+    long total = 0;
+    for(int i = 0; i < n_rows; i++){
+        for(int j = 0; j < n_cols; j++){
+            total += generateSet(this->grid[i][j]) + 1;
+        }
+    }
+
+    return total;
+}
+
+/*Flag pixels whose 8-neighborhood crosses iteration bands by more than the threshold*/
+std::vector<std::pair<int, int>> Mandelbrot::flagEdges(const std::vector<std::vector<int>>& iters, int iter_threshold){
+    std::vector<std::pair<int, int>> edges;
+    for(int i = 0; i < n_rows; i++){
+        for(int j = 0; j < n_cols; j++){
+            bool edge = false;
+            for(int di = -1; di <= 1 && !edge; di++){
+                for(int dj = -1; dj <= 1; dj++){
+                    int ni = i + di;
+                    int nj = j + dj;
+                    if(ni < 0 || ni >= n_rows || nj < 0 || nj >= n_cols) continue;
+                    if(abs(iters[ni][nj] - iters[i][j]) > iter_threshold){
+                        edge = true;
+                        break;
+                    }
+                }
+            }
+            if(edge) edges.push_back(std::make_pair(i, j));
+        }
+    }
+
+    return edges;
+}
+
+/*Evolve one jittered sample inside a cell of the stratified grid over a pixel footprint*/
+int Mandelbrot::sampleCell(int i, int j, int cx, int cy, int samples_per_axis, std::minstd_rand& rng){
+    std::uniform_real_distribution<float> jitter(0.0f, 1.0f);
+    float step = this->resolution/samples_per_axis;
+    float real = (float)j*this->resolution + r_min + (cx + jitter(rng))*step - this->resolution/2.0f;
+    float imag = (float)i*this->resolution + i_min + (cy + jitter(rng))*step - this->resolution/2.0f;
+
+    return generateSet(rotatePoint(real, imag));
+}
+
+/*Resample a flagged pixel: one cell per quadrant of the stratified grid is probed first, the remaining cells are only
+sampled if the probe disagrees. Probe samples are cells of the grid, so every sample carries the same weight*/
+long Mandelbrot::refinePixel(const std::vector<std::vector<int>>& iters, int i, int j, int samples_per_axis, int iter_threshold){
+    if(samples_per_axis < 2) return 0;
+    int s = samples_per_axis;
+    int half = s/2;
+    //Seed from the pixel position so the output does not depend on the thread schedule. seed_seq mixes the position,
+    //consecutive raw seeds would give neighboring pixels nearly identical first outputs and a regular sampling pattern
+    std::seed_seq seed{i, j};
+    std::minstd_rand rng(seed);
+    std::uniform_int_distribution<int> pick(0, half - 1);
+    std::vector<int> cells(s*s, -1);
+    long work = 0;
+
+    //Probe, quadrants are [0, s - half) and [s - half, s) along each axis
+    int lo_iter = iters[i][j];
+    int hi_iter = iters[i][j];
+    for(int qy = 0; qy < 2; qy++){
+        for(int qx = 0; qx < 2; qx++){
+            int cx = qx*(s - half) + pick(rng);
+            int cy = qy*(s - half) + pick(rng);
+            int iter = sampleCell(i, j, cx, cy, s, rng);
+            cells[cy*s + cx] = iter;
+            lo_iter = std::min(lo_iter, iter);
+            hi_iter = std::max(hi_iter, iter);
+            work += iter + 1;
+        }
+    }
+
+    //A consistent probe is averaged with the first sample, otherwise the full grid is completed and averaged
+    std::vector<int> samples;
+    if(hi_iter - lo_iter <= iter_threshold){
+        samples.push_back(iters[i][j]);
+        for(int c = 0; c < s*s; c++){
+            if(cells[c] >= 0) samples.push_back(cells[c]);
+        }
+    }
+    else{
+        for(int c = 0; c < s*s; c++){
+            if(cells[c] < 0){
+                cells[c] = sampleCell(i, j, c%s, c/s, s, rng);
+                work += cells[c] + 1;
+            }
+            samples.push_back(cells[c]);
+        }
+    }
+
+    int r = 0;
+    int g = 0;
+    int b = 0;
+    int n = (int)samples.size();
+    for(int iter : samples){
+        Pixel p = mapPixel(iter);
+        r += p.r;
+        g += p.g;
+        b += p.b;
+    }
+    this->image[i][j] = Pixel((r + n/2)/n, (g + n/2)/n, (b + n/2)/n);
+
+    return work;
+}
+
+/*Render one sample per pixel, then spend extra jittered samples only on pixels next to a change in iteration count*/
+void Mandelbrot::generateImageAA(int samples_per_axis, int iter_threshold){
+    makeGrid();
+    std::vector<std::vector<int>> iters(n_rows, std::vector<int>(n_cols, 0));
+
+    //Single sample pass, work is measured in iterations (+1 for the escape test of every sample)
+    long base_work = 0;
+    for(int i = 0; i < n_rows; i++){
+        for(int j = 0; j < n_cols; j++){
+            int iter = generateSet(this->grid[i][j]);
+            iters[i][j] = iter;
+            this->image[i][j] = mapPixel(iter);
+            base_work += iter + 1;
+        }
+    }
+
+    std::vector<std::pair<int, int>> edges = flagEdges(iters, iter_threshold);
+    long extra_work = 0;
+    for(size_t k = 0; k < edges.size(); k++){
+        extra_work += refinePixel(iters, edges[k].first, edges[k].second, samples_per_axis, iter_threshold);
+    }
+
+    this->refined = edges;
+    this->aa_cost = base_work > 0 ? (double)(base_work + extra_work)/base_work : 1.0;
+    return;
+}
+
 /*Save image as .ppm file*/
 void Mandelbrot::saveImage(const std::string& filename){
     std::ofstream file(filename, std::ios::out | std::ios::binary);
@@ -98,7 +250,7 @@ void ParallelMandelbrot::makeGrid(){
             float real = (float)j*this->resolution + r_min;
             float imag = (float)i*this->resolution + i_min;
 
-            this->grid[i][j] = Complex(real, imag);
+            this->grid[i][j] = rotatePoint(real, imag);
         }
     }
 }
@@ -125,3 +277,186 @@ void ParallelMandelbrot::generateImage(){
 
     return;
 }
+
+/*Boundary tracing generation*/
+/*Evolve a single pixel if it has not been evaluated yet and queue it for tracing*/
+void TracingMandelbrot::loadPixel(std::vector<std::vector<int>>& iters, std::vector<std::pair<int, int>>& queue, int i, int j){
+    if(iters[i][j] >= 0) return;
+    iters[i][j] = generateSet(this->grid[i][j]);
+    queue.push_back(std::make_pair(i, j));
+
+    return;
+}
+
+/*Evolves Mandelbrot set for c like generateSet, but stops as soon as the orbit repeats exactly (Brent's cycle detection).
+A repeating orbit can never escape, so the result is identical to generateSet while interior points exit early*/
+int TracingMandelbrot::confirmSet(Complex c){
+    Complex f = c;
+    Complex saved = c;
+    int power = 1;
+    int lambda = 0;
+    int iter = 0;
+
+    while(iter < this->max_iter){
+        if(magnitude(f) > this->threshold) break;
+        iter++;
+        f = f*f + c;
+        if(f.getReal() == saved.getReal() && f.getImag() == saved.getImag()) return this->max_iter;
+
+        //Move the saved point forward with doubling cycle lengths
+        lambda++;
+        if(lambda == power){
+            saved = f;
+            power *= 2;
+            lambda = 0;
+        }
+    }
+
+    return iter;
+}
+
+/*Trace contours between iteration bands inside a strip, then fill every enclosed pixel from its left neighbor*/
+long TracingMandelbrot::traceStrip(std::vector<std::vector<int>>& iters, int top, int bottom, long& confirmed){
+    if(bottom - top < 2) return 0;
+    long evaluated = 0;
+    std::vector<std::pair<int, int>> queue;
+
+    //Seed with the strip perimeter, seam rows are already evaluated but still have to be scanned
+    for(int j = 0; j < n_cols; j++){
+        queue.push_back(std::make_pair(top, j));
+        queue.push_back(std::make_pair(bottom, j));
+    }
+    for(int i = top + 1; i < bottom; i++){
+        loadPixel(iters, queue, i, 0);
+        loadPixel(iters, queue, i, n_cols - 1);
+    }
+
+    //A pixel with an evaluated neighbor in another band lies on a contour, evaluate all of its neighbors to follow it.
+    //The differing neighbor is queued again so both sides of the contour get expanded, each pixel expands at most once.
+    std::vector<std::vector<char>> expanded(bottom - top + 1, std::vector<char>(n_cols, 0));
+    const int di[4] = {-1, 1, 0, 0};
+    const int dj[4] = {0, 0, -1, 1};
+    while(!queue.empty()){
+        std::pair<int, int> p = queue.back();
+        queue.pop_back();
+        if(expanded[p.first - top][p.second]) continue;
+        int iter = iters[p.first][p.second];
+
+        bool on_contour = false;
+        for(int k = 0; k < 4; k++){
+            int i = p.first + di[k];
+            int j = p.second + dj[k];
+            if(i < top || i > bottom || j < 0 || j >= n_cols) continue;
+            if(iters[i][j] >= 0 && iters[i][j] != iter){
+                on_contour = true;
+                if(!expanded[i - top][j]) queue.push_back(std::make_pair(i, j));
+            }
+        }
+        if(!on_contour) continue;
+        expanded[p.first - top][p.second] = 1;
+
+        //Seam rows are never written, they belong to both neighboring strips
+        for(int k = 0; k < 4; k++){
+            int i = p.first + di[k];
+            int j = p.second + dj[k];
+            if(i <= top || i >= bottom || j < 0 || j >= n_cols) continue;
+            loadPixel(iters, queue, i, j);
+        }
+    }
+
+    //Every unevaluated pixel is enclosed by a single band, taken from the nearest evaluated pixel to its left.
+    //Enclosed interior pixels are confirmed since sub-pixel filaments can leave isolated escaping pixels inside the interior.
+    for(int i = top + 1; i < bottom; i++){
+        int band = iters[i][0];
+        for(int j = 0; j < n_cols; j++){
+            if(iters[i][j] >= 0){
+                band = iters[i][j];
+                evaluated++;
+            }
+            else if(band == this->max_iter){
+                iters[i][j] = confirmSet(this->grid[i][j]);
+                confirmed++;
+            }
+            else iters[i][j] = band;
+        }
+    }
+
+    return evaluated;
+}
+
+/*Partition the image into strips, evaluate the seam rows once, then trace and fill the strips in parallel*/
+void TracingMandelbrot::generateImage(){
+    //Too small to hold a strip between two seams
+    if(n_rows < 3){
+        ParallelMandelbrot::generateImage();
+        this->n_evaluated = (long)n_rows*n_cols;
+        this->n_confirmed = 0;
+        return;
+    }
+
+    makeGrid();
+    std::vector<std::vector<int>> iters(n_rows, std::vector<int>(n_cols, -1));
+
+    //Seam rows, including the first and last row of the image
+    int strips = std::max(1, std::min(this->n_strips, (n_rows - 1)/2));
+    long evaluated = (long)(strips + 1)*n_cols;
+    long confirmed = 0;
+    std::vector<int> seams(strips + 1);
+    for(int s = 0; s <= strips; s++){
+        seams[s] = (int)((long)s*(n_rows - 1)/strips);
+    }
+
+#pragma omp parallel num_threads(this->max_procs) reduction(+:evaluated, confirmed)
+{
+    #pragma omp for schedule(dynamic, 1)
+    for(int s = 0; s <= strips; s++){
+        for(int j = 0; j < n_cols; j++){
+            iters[seams[s]][j] = generateSet(this->grid[seams[s]][j]);
+        }
+    }
+
+    //Strips only write to rows strictly between their seams
+    #pragma omp for schedule(dynamic, 1)
+    for(int s = 0; s < strips; s++){
+        evaluated += traceStrip(iters, seams[s], seams[s+1], confirmed);
+    }
+}
+
+    this->n_evaluated = evaluated;
+    this->n_confirmed = confirmed;
+    for(int i = 0; i < n_rows; i++){
+        for(int j = 0; j < n_cols; j++){
+            this->image[i][j] = mapPixel(iters[i][j]);
+        }
+    }
+
+    return;
+}
+
+/*Adaptive anti-aliasing with the single sample pass and the refinement pass in parallel*/
+void ParallelMandelbrot::generateImageAA(int samples_per_axis, int iter_threshold){
+    makeGrid();
+    std::vector<std::vector<int>> iters(n_rows, std::vector<int>(n_cols, 0));
+
+    long base_work = 0;
+#pragma omp parallel for num_threads(this->max_procs) schedule(dynamic, 16) reduction(+:base_work)
+    for(int i = 0; i < n_rows; i++){
+        for(int j = 0; j < n_cols; j++){
+            int iter = generateSet(this->grid[i][j]);
+            iters[i][j] = iter;
+            this->image[i][j] = mapPixel(iter);
+            base_work += iter + 1;
+        }
+    }
+
+    std::vector<std::pair<int, int>> edges = flagEdges(iters, iter_threshold);
+    long extra_work = 0;
+#pragma omp parallel for num_threads(this->max_procs) schedule(dynamic, 16) reduction(+:extra_work)
+    for(int k = 0; k < (int)edges.size(); k++){
+        extra_work += refinePixel(iters, edges[k].first, edges[k].second, samples_per_axis, iter_threshold);
+    }
+
+    this->refined = edges;
+    this->aa_cost = base_work > 0 ? (double)(base_work + extra_work)/base_work : 1.0;
+    return;
+}
@@ -1,9 +1,18 @@
 #include "complex.h"
 #include "mandelbrot.h"
 #include "benchmark.h"
+#include "frameGenerator.h"
+#include "cameraPath.h"
 #include <iostream>
 #include <map>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
 #include "omp.h"
+#include "tests.h"
 
 void testComplex(){
     //Test Complex
@@ -19,6 +28,211 @@ void testComplex(){
     return;
 }
 
+/*Print the outcome of a single check and count failures*/
+static void check(bool ok, const std::string& name, int& failures){
+    printf("%s: %s\n", name.c_str(), ok ? "PASS" : "FAIL");
+    if(!ok) failures++;
+    return;
+}
+
+/*Compare boundary traced images against the brute force generator on every built-in region, returns number of mismatched pixels*/
+long testBoundaryTrace(int max_procs, float standard_res){
+    std::vector<std::string> regions = {"Seahorse", "Elephant Valley", "Feigenbaum"};
+    //Frame widths from the unzoomed view down to deep zooms
+    std::vector<float> widths = {4.0f, 0.4f, 0.04f, 0.004f};
+    int max_iter = 100;
+    float thresh = 2.0f;
+    long total_mismatches = 0;
+
+    for(const std::string& region : regions){
+        float r_center = 0.0f;
+        float i_center = 0.0f;
+        regionCenter(region, r_center, i_center);
+
+        for(float width : widths){
+            //Keep the pixel count of every frame the same as the unzoomed one
+            float res = standard_res*(width/widths[0]);
+            float r_min = r_center - width/2.0f;
+            float r_max = r_center + width/2.0f;
+            float i_min = i_center - width/2.0f;
+            float i_max = i_center + width/2.0f;
+
+            Mandelbrot brute(max_iter, thresh, res, r_max, r_min, i_max, i_min);
+            brute.generateImage();
+            TracingMandelbrot traced(max_procs, max_iter, thresh, res, r_max, r_min, i_max, i_min);
+            traced.generateImage();
+
+            const std::vector<std::vector<Pixel>>& a = brute.getImage();
+            const std::vector<std::vector<Pixel>>& b = traced.getImage();
+            long mismatches = 0;
+            long n_pixels = 0;
+            for(size_t i = 0; i < a.size(); i++){
+                for(size_t j = 0; j < a[i].size(); j++){
+                    if(a[i][j].r != b[i][j].r || a[i][j].g != b[i][j].g || a[i][j].b != b[i][j].b) mismatches++;
+                    n_pixels++;
+                }
+            }
+            total_mismatches += mismatches;
+
+            //Confirmed interior pixels are iterated too, they only exit early once their orbit repeats
+            long evolved = traced.getEvaluated() + traced.getConfirmed();
+            printf("%s: width %.4f, %ld traced + %ld confirmed = %ld/%ld pixels evolved, %ld mismatches %s\n", region.c_str(), width, 
+            traced.getEvaluated(), traced.getConfirmed(), evolved, n_pixels, mismatches, mismatches == 0 ? "PASS" : "FAIL");
+        }
+    }
+
+    return total_mismatches;
+}
+
+/*Check adaptive anti-aliasing on every built-in region and report its extra work, returns number of failed checks*/
+int testAntialiasing(int max_procs, float standard_res){
+    std::vector<std::string> regions = {"Seahorse", "Elephant Valley", "Feigenbaum"};
+    std::vector<float> widths = {4.0f, 0.04f};
+    int max_iter = 100;
+    float thresh = 2.0f;
+    int samples_per_axis = 4;
+    int iter_threshold = 32;
+    int failures = 0;
+
+    for(const std::string& region : regions){
+        float r_center = 0.0f;
+        float i_center = 0.0f;
+        regionCenter(region, r_center, i_center);
+
+        for(float width : widths){
+            float res = standard_res*(width/widths[0]);
+            float r_max = r_center + width/2.0f;
+            float r_min = r_center - width/2.0f;
+            float i_max = i_center + width/2.0f;
+            float i_min = i_center - width/2.0f;
+
+            Mandelbrot plain(max_iter, thresh, res, r_max, r_min, i_max, i_min);
+            plain.generateImage();
+            Mandelbrot serial(max_iter, thresh, res, r_max, r_min, i_max, i_min);
+            serial.generateImageAA(samples_per_axis, iter_threshold);
+            ParallelMandelbrot parallel(max_procs, max_iter, thresh, res, r_max, r_min, i_max, i_min);
+            parallel.generateImageAA(samples_per_axis, iter_threshold);
+
+            const std::vector<std::vector<Pixel>>& a = plain.getImage();
+            const std::vector<std::vector<Pixel>>& b = serial.getImage();
+            const std::vector<std::vector<Pixel>>& c = parallel.getImage();
+            std::vector<std::vector<bool>> flagged(a.size(), std::vector<bool>(a.empty() ? 0 : a[0].size(), false));
+            for(const std::pair<int, int>& p : serial.getRefinedPixels()) flagged[p.first][p.second] = true;
+
+            bool unflagged_same = true;
+            bool parallel_same = true;
+            for(size_t i = 0; i < a.size(); i++){
+                for(size_t j = 0; j < a[i].size(); j++){
+                    if(!flagged[i][j] && (a[i][j].r != b[i][j].r || a[i][j].g != b[i][j].g || a[i][j].b != b[i][j].b)) unflagged_same = false;
+                    if(b[i][j].r != c[i][j].r || b[i][j].g != c[i][j].g || b[i][j].b != c[i][j].b) parallel_same = false;
+                }
+            }
+
+            long n_pixels = (long)a.size()*(a.empty() ? 0 : a[0].size());
+            printf("%s: width %.4f, %ld/%ld pixels refined, %.3fx cost\n", region.c_str(), width, 
+            serial.getRefined(), n_pixels, serial.getAACost());
+
+            char label[96];
+            snprintf(label, sizeof(label), "%s width %.4f", region.c_str(), width);
+            check(unflagged_same, std::string(label) + ": unflagged pixels match generateImage", failures);
+            check(parallel_same && serial.getRefined() == parallel.getRefined(), std::string(label) + ": serial and parallel images match", failures);
+            check(serial.getAACost() >= 1.0 && (serial.getRefined() > 0 || serial.getAACost() == 1.0), 
+            std::string(label) + ": cost is at least 1x and exactly 1x without refinement", failures);
+        }
+    }
+
+    return failures;
+}
+
+/*Write a keyframe file and try to load it*/
+static bool loadKeyframeText(const std::string& text, std::vector<Keyframe>& keyframes){
+    //Temporary file so the test does not write into the working directory
+    char name[] = P_tmpdir "/keyframes_XXXXXX";
+    int fd = mkstemp(name);
+    if(fd < 0) return false;
+    close(fd);
+    std::string path = name;
+    std::ofstream file(path);
+    file << text;
+    file.close();
+    bool ok = loadKeyframes(path, keyframes);
+    std::remove(path.c_str());
+
+    return ok;
+}
+
+/*Check keyframe parsing, path interpolation and cost ordering of frames, returns number of failed checks*/
+int testCameraPath(int max_procs){
+    int failures = 0;
+    std::vector<Keyframe> keys;
+
+    //Parsing
+    bool ok = loadKeyframeText("# comment line\n\n-0.5 0.0 4.0 0 100  # trailing comment\n0.25 0.5 0.1 90 200\n", keys);
+    check(ok && keys.size() == 2 && keys[1].r_center == 0.25f && keys[1].i_center == 0.5f && keys[1].width == 0.1f 
+    && keys[1].rotation == 90.0f && keys[1].max_iter == 200, "loadKeyframes reads keyframes and skips comments", failures);
+    check(!loadKeyframeText("-0.5 0.0 4.0 0\n", keys), "loadKeyframes rejects missing fields", failures);
+    check(!loadKeyframeText("-0.5 0.0 abc 0 100\n", keys), "loadKeyframes rejects non-numeric fields", failures);
+    check(!loadKeyframeText("-0.5 0.0 0.0 0 100\n", keys), "loadKeyframes rejects width <= 0", failures);
+    check(!loadKeyframeText("-0.5 0.0 4.0 0 0\n", keys), "loadKeyframes rejects max_iter <= 0", failures);
+    check(!loadKeyframeText("# only comments\n", keys), "loadKeyframes rejects files without keyframes", failures);
+    check(!loadKeyframes("missing_keyframes.txt", keys), "loadKeyframes rejects missing files", failures);
+
+    //Interpolation passes through every keyframe when frames line up with them
+    keys = {Keyframe(0.0f, 0.0f, 4.0f, 0.0f, 100), Keyframe(-0.75f, 0.1f, 1.0f, 45.0f, 200), Keyframe(-0.75f, 0.1f, 1e-4f, 90.0f, 400)};
+    int n_frames = 201;
+    std::vector<Keyframe> path = interpolatePath(keys, n_frames);
+    bool through = path.size() == (size_t)n_frames;
+    for(size_t k = 0; k < keys.size() && through; k++){
+        const Keyframe& frame = path[k*(n_frames - 1)/(keys.size() - 1)];
+        through = fabs(frame.r_center - keys[k].r_center) < 1e-6f && fabs(frame.i_center - keys[k].i_center) < 1e-6f 
+        && fabs(frame.width/keys[k].width - 1.0f) < 1e-4f && fabs(frame.rotation - keys[k].rotation) < 1e-4f && frame.max_iter == keys[k].max_iter;
+    }
+    check(through, "interpolatePath passes through keyframes", failures);
+
+    //Zooming between two keyframes with the same center must keep that center in view
+    bool in_view = true;
+    for(int frame = (n_frames - 1)/2; frame < n_frames; frame++){
+        in_view = in_view && fabs(path[frame].r_center - keys[2].r_center) <= path[frame].width/2.0f 
+        && fabs(path[frame].i_center - keys[2].i_center) <= path[frame].width/2.0f;
+    }
+    check(in_view, "interpolatePath keeps a shared center in view while zooming", failures);
+
+    path = interpolatePath(keys, 1);
+    check(path.size() == 1 && path[0].r_center == keys[0].r_center && path[0].width == keys[0].width, "interpolatePath with one frame", failures);
+    path = interpolatePath(std::vector<Keyframe>(1, keys[1]), 5);
+    bool constant = path.size() == 5;
+    for(const Keyframe& frame : path) constant = constant && frame.r_center == keys[1].r_center && frame.width == keys[1].width;
+    check(constant, "interpolatePath with one keyframe", failures);
+    check(interpolatePath(keys, 0).empty() && interpolatePath(std::vector<Keyframe>(), 5).empty(), "interpolatePath without frames or keyframes", failures);
+
+    //Frames are dispatched in decreasing order of probed cost
+    path = interpolatePath(keys, 16);
+    std::vector<long> costs;
+    std::vector<int> order = scheduleFrames(max_procs, path, costs);
+    std::vector<bool> seen(path.size(), false);
+    bool sorted = order.size() == path.size() && costs.size() == path.size();
+    for(size_t k = 0; k < order.size() && sorted; k++){
+        sorted = order[k] >= 0 && order[k] < (int)path.size() && !seen[order[k]] && (k == 0 || costs[order[k-1]] >= costs[order[k]]);
+        if(sorted) seen[order[k]] = true;
+    }
+    check(sorted, "scheduleFrames orders frames by decreasing cost", failures);
+
+    //Probe costs have to follow the real render cost: a deep, high max_iter frame renders slower than the unzoomed view
+    std::vector<Keyframe> pair = {Keyframe(-0.5f, 0.0f, 4.0f, 0.0f, 100), Keyframe(-0.743643887f, 0.131825904f, 1e-3f, 0.0f, 1000)};
+    std::vector<long> render_costs;
+    for(const Keyframe& key : pair){
+        float res = key.width/128.0f;
+        Mandelbrot render(key.max_iter, 2.0f, res, key.r_center + key.width/2.0f, key.r_center - key.width/2.0f, 
+        key.i_center + key.width/2.0f, key.i_center - key.width/2.0f);
+        render_costs.push_back(render.countIterations());
+    }
+    order = scheduleFrames(max_procs, pair, costs);
+    check(render_costs[1] > render_costs[0] && costs[1] > costs[0] && order.size() == 2 && order[0] == 1, 
+    "scheduleFrames probes a deep frame as more expensive and dispatches it first", failures);
+
+    return failures;
+}
+
 /*Benchmark singlethreaded vs multithreaded generation*/
 int main2(){
     /*Setup Experiments*/